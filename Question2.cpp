@@ -2,13 +2,515 @@
  CSC 301 - Data Structures
  Tutor-Marked Assessment
  Question 2: Solving Problems Using Recursion
+
+ Build: g++ -std=c++17 -O2 -pthread Question2.cpp -o recursion
+ Run:   ./recursion          (tests)
+        ./recursion --bench  (tests followed by benchmarks)
+
+ Profiling build: add -DRECURSION_PROFILING (and optionally
+ -DRECURSION_PROFILING_REDUNDANCY), then the run ends with a report of call
+ counts, depth and timing. For JSON instead of the table:
+        ./recursion --profile-json         (JSON on stderr)
+        ./recursion --profile-json=<path>  (JSON written to <path>)
  */
 
 #include <iostream>
+#include <fstream>
 #include <string>
 #include <vector>
+#include <deque>
+#include <memory>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <chrono>
+#include <list>
+#include <unordered_map>
+#include <tuple>
+#include <type_traits>
+#include <algorithm>
 using namespace std;
 
+// ============================================================================
+// RECURSION PROFILER
+// ============================================================================
+
+/*
+ Purpose: Measure what the recursive functions cost without printing per call
+ Usage:
+ - Build with -DRECURSION_PROFILING to turn it on; otherwise
+   RECURSION_PROFILE(...) expands to nothing and adds no code at all
+ - Add -DRECURSION_PROFILING_REDUNDANCY as well to count redundant
+   subproblem hits (costs one extra array lookup per call)
+ - An instrumented function starts with RECURSION_PROFILE(site, key), where
+   site says which function it is and key identifies the subproblem (calls
+   with the same arguments must give the same key). Keys are small
+   non-negative integers; -1 means "do not track this call"
+ What it records (per function, per thread):
+ - calls:          every call, including all recursive ones
+ - max depth:      deepest recursion reached
+ - top-level time: wall time of each outermost call (depth 1)
+ - redundant hits: calls for a subproblem already solved earlier in the same
+                   top-level call - the work memoization would save
+ Counters are plain integers in thread_local storage: each call does a few
+ increments and compares, and only the outermost call reads the clock.
+ Each thread's totals are merged into a global table when the thread exits.
+ A task stolen by a scheduler worker starts at depth 1 on that worker, so it
+ counts as its own top-level call
+ */
+enum RecursionSite {
+    SITE_FACTORIAL,
+    SITE_FIBONACCI,
+    SITE_REVERSE_STRING,
+    SITE_BINARY_SEARCH,
+    SITE_COUNT
+};
+
+#ifdef RECURSION_PROFILING
+
+const char* const recursionSiteNames[SITE_COUNT] = {
+    "calculateFactorial", "fibonacci", "reverseString", "recursiveBinarySearch"
+};
+
+// One function's counters on one thread. A plain struct with no constructor,
+// so the thread_local array below needs no per-access initialisation check
+struct RecursionProfileTotals {
+    unsigned long long calls;
+    unsigned long long maxDepth;
+    unsigned long long topLevelCalls;
+    unsigned long long topLevelNanos;
+    unsigned long long maxTopLevelNanos;
+    unsigned long long redundantHits;
+};
+
+struct RecursionSiteState {
+    RecursionProfileTotals totals;
+    unsigned long long depth;
+    long long topLevelStartNanos;
+};
+
+thread_local RecursionSiteState recursionSiteStates[SITE_COUNT];
+thread_local bool recursionProfileAttached = false;
+
+// Keeps track of live threads' counters and the totals of threads that have exited
+class RecursionProfileRegistry {
+public:
+    static RecursionProfileRegistry& instance() {
+        static RecursionProfileRegistry registry;
+        return registry;
+    }
+
+    void attach(RecursionSiteState* states) {
+        lock_guard<mutex> guard(lock);
+        live.push_back(states);
+    }
+
+    void detach(RecursionSiteState* states) {
+        lock_guard<mutex> guard(lock);
+        addTo(retired, states);
+        live.erase(find(live.begin(), live.end(), states));
+    }
+
+    // Reads other threads' counters without synchronising with them, so call
+    // it when the other instrumented threads are idle or have been joined
+    vector<RecursionProfileTotals> collect() {
+        lock_guard<mutex> guard(lock);
+        vector<RecursionProfileTotals> totals = retired;
+        for (RecursionSiteState* states : live) {
+            addTo(totals, states);
+        }
+        return totals;
+    }
+
+private:
+    mutex lock;
+    vector<RecursionSiteState*> live;
+    vector<RecursionProfileTotals> retired = vector<RecursionProfileTotals>(SITE_COUNT, RecursionProfileTotals{});
+
+    static void addTo(vector<RecursionProfileTotals>& totals, const RecursionSiteState* states) {
+        for (int site = 0; site < SITE_COUNT; ++site) {
+            const RecursionProfileTotals& from = states[site].totals;
+            RecursionProfileTotals& to = totals[site];
+            to.calls += from.calls;
+            to.maxDepth = max(to.maxDepth, from.maxDepth);
+            to.topLevelCalls += from.topLevelCalls;
+            to.topLevelNanos += from.topLevelNanos;
+            to.maxTopLevelNanos = max(to.maxTopLevelNanos, from.maxTopLevelNanos);
+            to.redundantHits += from.redundantHits;
+        }
+    }
+};
+
+// Registers this thread's counters on its first top-level call and merges
+// them into the global totals when the thread exits
+void attachRecursionProfile() {
+    struct Detacher {
+        Detacher() { RecursionProfileRegistry::instance().attach(recursionSiteStates); }
+        ~Detacher() { RecursionProfileRegistry::instance().detach(recursionSiteStates); }
+    };
+    thread_local Detacher detacher;
+    recursionProfileAttached = true;
+}
+
+long long recursionProfileNowNanos() {
+    return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+#ifdef RECURSION_PROFILING_REDUNDANCY
+/*
+ S *truct: RecursionSubproblemStamps
+ Purpose: Remembers which keys were already seen in the current top-level
+ call. Instead of a hashed set that must be cleared, each key stores the
+ number of the top-level call that last saw it; starting a new top-level call
+ just increments that number. Keys at or above maxKey are not tracked
+ */
+struct RecursionSubproblemStamps {
+    static const long long maxKey = 1 << 24;
+    vector<unsigned> stamps;
+    unsigned current = 0;
+
+    void startTopLevel() {
+        if (++current == 0) {
+            fill(stamps.begin(), stamps.end(), 0u);
+            current = 1;
+        }
+    }
+
+    bool seenBefore(long long key) {
+        if (key < 0 || key >= maxKey) {
+            return false;
+        }
+        size_t index = static_cast<size_t>(key);
+        if (index >= stamps.size()) {
+            stamps.resize(max(index + 1, stamps.size() * 2), 0u);
+        }
+        bool seen = stamps[index] == current;
+        stamps[index] = current;
+        return seen;
+    }
+};
+
+thread_local RecursionSubproblemStamps recursionSubproblemStamps[SITE_COUNT];
+#endif
+
+/*
+ C *lass: RecursionProfileScope
+ Purpose: Created at the start of an instrumented call and destroyed when it
+ returns, so depth and top-level timing follow the real call stack
+ */
+class RecursionProfileScope {
+public:
+    RecursionProfileScope(RecursionSite site, long long key)
+        : state(recursionSiteStates[site]) {
+        unsigned long long depth = ++state.depth;
+        state.totals.calls++;
+        if (depth > state.totals.maxDepth) {
+            state.totals.maxDepth = depth;
+        }
+        if (depth == 1) {
+            startTopLevel(site);
+        }
+#ifdef RECURSION_PROFILING_REDUNDANCY
+        if (recursionSubproblemStamps[site].seenBefore(key)) {
+            state.totals.redundantHits++;
+        }
+#else
+        (void)key;
+#endif
+    }
+
+    ~RecursionProfileScope() {
+        if (--state.depth == 0) {
+            finishTopLevel();
+        }
+    }
+
+    RecursionProfileScope(const RecursionProfileScope&) = delete;
+    RecursionProfileScope& operator=(const RecursionProfileScope&) = delete;
+
+private:
+    RecursionSiteState& state;
+
+    void startTopLevel(RecursionSite site) {
+        if (!recursionProfileAttached) {
+            attachRecursionProfile();
+        }
+#ifdef RECURSION_PROFILING_REDUNDANCY
+        recursionSubproblemStamps[site].startTopLevel();
+#else
+        (void)site;
+#endif
+        state.topLevelStartNanos = recursionProfileNowNanos();
+    }
+
+    void finishTopLevel() {
+        unsigned long long nanos = recursionProfileNowNanos() - state.topLevelStartNanos;
+        state.totals.topLevelCalls++;
+        state.totals.topLevelNanos += nanos;
+        if (nanos > state.totals.maxTopLevelNanos) {
+            state.totals.maxTopLevelNanos = nanos;
+        }
+    }
+};
+
+#define RECURSION_PROFILE(site, key) RecursionProfileScope recursionProfileScope(site, key)
+
+#ifdef RECURSION_PROFILING_REDUNDANCY
+const bool recursionProfileTracksRedundancy = true;
+#else
+const bool recursionProfileTracksRedundancy = false;
+#endif
+
+// Human-readable table of everything recorded so far
+void printRecursionProfile(ostream& out) {
+    vector<RecursionProfileTotals> totals = RecursionProfileRegistry::instance().collect();
+    out << "\n=== RECURSION PROFILE ===" << endl;
+    out << "function | calls | max depth | top-level calls | avg top-level ns | max top-level ns | redundant hits" << endl;
+    for (int site = 0; site < SITE_COUNT; ++site) {
+        const RecursionProfileTotals& t = totals[site];
+        out << recursionSiteNames[site] << " | " << t.calls << " | " << t.maxDepth << " | "
+            << t.topLevelCalls << " | " << (t.topLevelCalls ? t.topLevelNanos / t.topLevelCalls : 0) << " | "
+            << t.maxTopLevelNanos << " | ";
+        if (recursionProfileTracksRedundancy) {
+            out << t.redundantHits << endl;
+        } else {
+            out << "- (build with -DRECURSION_PROFILING_REDUNDANCY)" << endl;
+        }
+    }
+}
+
+// The same data as a JSON object keyed by function name; redundant_hits is
+// null unless redundancy tracking was compiled in
+void printRecursionProfileJson(ostream& out) {
+    vector<RecursionProfileTotals> totals = RecursionProfileRegistry::instance().collect();
+    out << "{";
+    for (int site = 0; site < SITE_COUNT; ++site) {
+        const RecursionProfileTotals& t = totals[site];
+        out << (site ? ", " : "") << "\"" << recursionSiteNames[site] << "\": {"
+            << "\"calls\": " << t.calls
+            << ", \"max_depth\": " << t.maxDepth
+            << ", \"top_level_calls\": " << t.topLevelCalls
+            << ", \"top_level_total_ns\": " << t.topLevelNanos
+            << ", \"top_level_max_ns\": " << t.maxTopLevelNanos
+            << ", \"redundant_hits\": ";
+        if (recursionProfileTracksRedundancy) {
+            out << t.redundantHits;
+        } else {
+            out << "null";
+        }
+        out << "}";
+    }
+    out << "}" << endl;
+}
+
+#else
+
+#define RECURSION_PROFILE(site, key) ((void)0)
+
+#endif
+
+// ============================================================================
+// MEMOIZATION WITH A SHARDED CONCURRENT CACHE
+// ============================================================================
+
+/*
+ S *truct: MemoCacheOptions
+ Purpose: Settings for memoize()
+ - enabled:  false turns the wrapper into plain recursion (useful to compare)
+ - capacity: maximum number of cached results over all shards
+ - shards:   number of independently locked parts of the cache
+ - evict:    when a shard is full, drop its least recently used entry (true)
+             or simply stop caching new results (false)
+ */
+struct MemoCacheOptions {
+    bool enabled = true;
+    size_t capacity = 1 << 16;
+    size_t shards = 16;
+    bool evict = true;
+};
+
+// Combines the std::hash of every argument so a whole argument list can be a key
+struct ArgumentsHash {
+    template <typename... T>
+    size_t operator()(const tuple<T...>& args) const {
+        size_t seed = 0;
+        apply([&seed](const auto&... value) {
+            ((seed ^= hash<decay_t<decltype(value)>>{}(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2)), ...);
+        }, args);
+        return seed;
+    }
+};
+
+/*
+ C *lass: ShardedCache
+ Purpose: A bounded key -> value cache that many threads can use at once
+ How it works:
+ - The keys are spread over several shards by hash; each shard has its own
+   mutex, so threads working on different keys rarely wait for each other
+ - Each shard keeps its entries in a list ordered from most to least recently
+   used, plus a hash map from key to list position for O(1) lookups
+ - The capacity is split exactly over the shards (the first capacity % shards
+   shards get one extra slot), so the whole cache never holds more than
+   capacity entries. There are never more shards than slots
+ */
+template <typename Key, typename Value, typename Hash = hash<Key>>
+class ShardedCache {
+public:
+    ShardedCache(size_t capacity, size_t shardCount, bool evict)
+        : evictWhenFull(evict) {
+        shardCount = max<size_t>(1, min(shardCount, capacity));
+        for (size_t i = 0; i < shardCount; ++i) {
+            shards.push_back(make_unique<Shard>());
+            shards.back()->capacity = capacity / shardCount + (i < capacity % shardCount ? 1 : 0);
+        }
+    }
+
+    // Look up key; on a hit copy the value into result and mark it recently used
+    bool find(const Key& key, Value& result) {
+        Shard& shard = shardFor(key);
+        lock_guard<mutex> guard(shard.lock);
+        auto found = shard.index.find(key);
+        if (found == shard.index.end()) {
+            shard.misses++;
+            return false;
+        }
+        if (evictWhenFull) {
+            shard.order.splice(shard.order.begin(), shard.order, found->second);
+        }
+        result = found->second->second;
+        shard.hits++;
+        return true;
+    }
+
+    void insert(const Key& key, const Value& value) {
+        Shard& shard = shardFor(key);
+        lock_guard<mutex> guard(shard.lock);
+        if (shard.capacity == 0 || shard.index.count(key) != 0) {
+            return;  // Caching is off, or another thread stored the same result first
+        }
+        if (shard.index.size() >= shard.capacity) {
+            if (!evictWhenFull) {
+                return;
+            }
+            shard.index.erase(shard.order.back().first);
+            shard.order.pop_back();
+            shard.evictions++;
+        }
+        shard.order.emplace_front(key, value);
+        shard.index[key] = shard.order.begin();
+    }
+
+    void clear() {
+        for (auto& shard : shards) {
+            lock_guard<mutex> guard(shard->lock);
+            shard->order.clear();
+            shard->index.clear();
+            shard->hits = shard->misses = shard->evictions = 0;
+        }
+    }
+
+    size_t size() const { return sumOver([](const Shard& s) { return s.index.size(); }); }
+    size_t hits() const { return sumOver([](const Shard& s) { return s.hits; }); }
+    size_t misses() const { return sumOver([](const Shard& s) { return s.misses; }); }
+    size_t evictions() const { return sumOver([](const Shard& s) { return s.evictions; }); }
+
+    // Rough heap usage: one list node and one hash map node per entry, plus buckets
+    size_t approximateBytes() const {
+        size_t perEntry = sizeof(pair<Key, Value>) + 2 * sizeof(void*)      // list node
+                        + sizeof(Key) + sizeof(void*) + 2 * sizeof(void*);  // map node
+        return size() * perEntry
+             + sumOver([](const Shard& s) { return s.index.bucket_count(); }) * sizeof(void*);
+    }
+
+private:
+    // alignas keeps two shards' locks off the same cache line
+    struct alignas(64) Shard {
+        mutable mutex lock;
+        list<pair<Key, Value>> order;  // front = most recently used
+        unordered_map<Key, typename list<pair<Key, Value>>::iterator, Hash> index;
+        size_t capacity = 0;
+        size_t hits = 0;
+        size_t misses = 0;
+        size_t evictions = 0;
+    };
+
+    vector<unique_ptr<Shard>> shards;
+    bool evictWhenFull;
+
+    Shard& shardFor(const Key& key) {
+        return *shards[Hash{}(key) % shards.size()];
+    }
+
+    template <typename F>
+    size_t sumOver(F field) const {
+        size_t total = 0;
+        for (const auto& shard : shards) {
+            lock_guard<mutex> guard(shard->lock);
+            total += field(*shard);
+        }
+        return total;
+    }
+};
+
+/*
+ C *lass: Memoized<R(Args...)>
+ Purpose: Wraps a recursive function so each distinct argument list is only
+ computed once (while it stays in the cache)
+ Usage: The function is written Y-combinator style - instead of calling itself
+ by name it receives the memoized wrapper as its first parameter "self", so
+ every recursive call also goes through the cache:
+
+     auto fib = memoize<int(int)>([](const auto& self, int n) {
+         return n < 2 ? n : self(n - 1) + self(n - 2);
+     });
+
+ Note: The cache lock is never held while the function runs, so two threads
+ may occasionally compute the same value; both get the right answer
+ */
+template <typename Signature>
+class Memoized;
+
+template <typename R, typename... Args>
+class Memoized<R(Args...)> {
+public:
+    using Key = tuple<decay_t<Args>...>;
+    using Body = function<R(const Memoized&, Args...)>;
+
+    Memoized(Body fn, MemoCacheOptions cacheOptions)
+        : body(std::move(fn)), options(cacheOptions),
+          cache(cacheOptions.capacity, cacheOptions.shards, cacheOptions.evict) {}
+
+    R operator()(Args... args) const {
+        if (!options.enabled) {
+            return body(*this, args...);
+        }
+
+        Key key(args...);
+        R result;
+        if (cache.find(key, result)) {
+            return result;
+        }
+        result = body(*this, args...);
+        cache.insert(key, result);
+        return result;
+    }
+
+    ShardedCache<Key, R, ArgumentsHash>& cacheStore() const { return cache; }
+
+private:
+    Body body;
+    MemoCacheOptions options;
+    mutable ShardedCache<Key, R, ArgumentsHash> cache;
+};
+
+template <typename Signature, typename F>
+Memoized<Signature> memoize(F&& fn, MemoCacheOptions options = {}) {
+    return Memoized<Signature>(std::forward<F>(fn), options);
+}
+
 // ============================================================================
 // FACTORIAL CALCULATION USING RECURSION
 // ============================================================================
@@ -24,19 +526,29 @@ using namespace std;
  - The recursive approach breaks down the problem into smaller subproblems
  */
 long long calculateFactorial(int n) {
+    RECURSION_PROFILE(SITE_FACTORIAL, n);
+
     // BASE CASE: If n is 0 or 1, factorial is 1
     // This stops the recursion from going forever
     if (n == 0 || n == 1) {
-        cout << "Base case reached: factorial(" << n << ") = 1" << endl;
         return 1;
     }
 
     // RECURSIVE CASE: n * factorial(n-1)
     // The function calls itself with a smaller value (n-1)
-    cout << "Calculating " << n << " * factorial(" << n-1 << ")" << endl;
-    long long result = n * calculateFactorial(n - 1);
-    cout << "Returning " << n << "! = " << result << endl;
-    return result;
+    return n * calculateFactorial(n - 1);
+}
+
+/*
+ F *unction: memoizedFactorial
+ Purpose: Same recursion as calculateFactorial, but every k! that has been
+ computed once is reused by later calls
+ */
+long long memoizedFactorial(int n) {
+    static Memoized<long long(int)> cached = memoize<long long(int)>([](const auto& self, int k) -> long long {
+        return k <= 1 ? 1 : k * self(k - 1);
+    });
+    return cached(n);
 }
 
 void testFactorial() {
@@ -76,6 +588,8 @@ void testFactorial() {
  - This shows the "tree-like" structure of recursion
  */
 int fibonacci(int n) {
+    RECURSION_PROFILE(SITE_FIBONACCI, n);
+
     // BASE CASE 1: fibonacci(0) = 0
     if (n == 0) {
         return 0;
@@ -90,10 +604,23 @@ int fibonacci(int n) {
     return fibonacci(n - 1) + fibonacci(n - 2);
 }
 
+/*
+ F *unction: memoizedFibonacci
+ Purpose: Same recursion as fibonacci, but each fibonacci(k) is computed once
+ and reused. printFibonacciSequence asks for every i in turn, which without a
+ cache recomputes the same subtrees over and over
+ */
+int memoizedFibonacci(int n) {
+    static Memoized<int(int)> cached = memoize<int(int)>([](const auto& self, int k) {
+        return k < 2 ? k : self(k - 1) + self(k - 2);
+    });
+    return cached(n);
+}
+
 void printFibonacciSequence(int n) {
     cout << "First " << n << " Fibonacci numbers: ";
     for (int i = 0; i < n; i++) {
-        cout << fibonacci(i) << " ";
+        cout << memoizedFibonacci(i) << " ";
     }
     cout << endl;
 }
@@ -133,6 +660,9 @@ void testFibonacci() {
  - This builds the reversed string from the end to the beginning
  */
 string reverseString(const string& str) {
+    // Each call works on a suffix of the original, so its length identifies it
+    RECURSION_PROFILE(SITE_REVERSE_STRING, static_cast<long long>(str.length()));
+
     // BASE CASE: If string is empty or has only one character, it's already reversed
     if (str.length() <= 1) {
         return str;
@@ -188,6 +718,9 @@ void testStringReversal() {
  - Each recursive call works on a smaller portion of the array
  */
 int recursiveBinarySearch(const vector<int>& arr, int target, int left, int right) {
+    // Each call of one search covers a different range, so there is no key to track
+    RECURSION_PROFILE(SITE_BINARY_SEARCH, -1);
+
     // BASE CASE 1: Element not found - search space is empty
     if (left > right) {
         return -1;
@@ -239,11 +772,953 @@ void testBinarySearch() {
     cout << "Search for 100: " << (result4 != -1 ? "Found at index " + to_string(result4) : "Not found") << endl;
 }
 
+// ============================================================================
+// WORK-STEALING TASK SCHEDULER (FORK/JOIN)
+// ============================================================================
+
+/*
+ C *lass: WorkStealingScheduler
+ Purpose: To run the two halves of a divide-and-conquer step on different cores
+ How it works:
+ - Every worker thread owns a deque of pending tasks
+ - A worker pushes and pops its own tasks at the back (newest first, so the
+   data it just touched is still in cache)
+ - An idle worker steals from the front of another worker's deque (the oldest
+   task, which is usually the biggest remaining piece of the recursion tree)
+ - forkJoin(a, b) makes b available for stealing, runs a itself, then keeps
+   running other tasks until b has finished, so a join never leaves a core idle
+ - Threads that are not workers (e.g. main) use one extra shared deque
+ */
+class WorkStealingScheduler {
+public:
+    explicit WorkStealingScheduler(unsigned numWorkers = thread::hardware_concurrency())
+        : workerTotal(numWorkers == 0 ? 1 : numWorkers) {
+        // One deque per worker plus one for outside callers
+        for (size_t i = 0; i <= workerTotal; ++i) {
+            queues.push_back(make_unique<WorkerQueue>());
+        }
+        for (size_t i = 0; i < workerTotal; ++i) {
+            workers.emplace_back([this, i] { workerLoop(i); });
+        }
+    }
+
+    ~WorkStealingScheduler() {
+        stopping.store(true, memory_order_release);
+        wakeUp.notify_all();
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+    WorkStealingScheduler(const WorkStealingScheduler&) = delete;
+    WorkStealingScheduler& operator=(const WorkStealingScheduler&) = delete;
+
+    size_t workerCount() const { return workerTotal; }
+
+    // Run a and b in parallel and return when both have finished.
+    // If either side throws, the exception is rethrown here after the join.
+    template <typename A, typename B>
+    void forkJoin(A&& a, B&& b) {
+        size_t self = callerQueueIndex();
+        JoinState join;
+        push(self, Task{function<void()>(std::forward<B>(b)), &join});
+
+        exception_ptr firstError;
+        try {
+            a();
+        } catch (...) {
+            firstError = current_exception();
+        }
+
+        // If nobody stole b it is still at the back of our deque, so the
+        // first tryRunOne() below usually runs it right here
+        while (!join.done.load(memory_order_acquire)) {
+            if (!tryRunOne(self)) {
+                this_thread::yield();
+            }
+        }
+
+        if (firstError) {
+            rethrow_exception(firstError);
+        }
+        if (join.error) {
+            rethrow_exception(join.error);
+        }
+    }
+
+private:
+    struct JoinState {
+        atomic<bool> done{false};
+        exception_ptr error;
+    };
+
+    struct Task {
+        function<void()> fn;
+        JoinState* join = nullptr;
+    };
+
+    struct WorkerQueue {
+        mutex lock;
+        deque<Task> tasks;
+    };
+
+    size_t workerTotal;
+    vector<unique_ptr<WorkerQueue>> queues;  // queues[workerTotal] belongs to outside callers
+    vector<thread> workers;
+    atomic<bool> stopping{false};
+    atomic<int> queuedTasks{0};
+    mutex sleepLock;
+    condition_variable wakeUp;
+
+    // Which scheduler (if any) the current thread is a worker of, and its deque
+    static thread_local WorkStealingScheduler* currentScheduler;
+    static thread_local size_t currentQueue;
+
+    size_t callerQueueIndex() const {
+        return currentScheduler == this ? currentQueue : workerTotal;
+    }
+
+    void push(size_t index, Task task) {
+        {
+            lock_guard<mutex> guard(queues[index]->lock);
+            queues[index]->tasks.push_back(std::move(task));
+        }
+        queuedTasks.fetch_add(1, memory_order_release);
+        wakeUp.notify_one();
+    }
+
+    bool popBack(size_t index, Task& task) {
+        lock_guard<mutex> guard(queues[index]->lock);
+        if (queues[index]->tasks.empty()) {
+            return false;
+        }
+        task = std::move(queues[index]->tasks.back());
+        queues[index]->tasks.pop_back();
+        queuedTasks.fetch_sub(1, memory_order_relaxed);
+        return true;
+    }
+
+    bool stealFront(size_t index, Task& task) {
+        lock_guard<mutex> guard(queues[index]->lock);
+        if (queues[index]->tasks.empty()) {
+            return false;
+        }
+        task = std::move(queues[index]->tasks.front());
+        queues[index]->tasks.pop_front();
+        queuedTasks.fetch_sub(1, memory_order_relaxed);
+        return true;
+    }
+
+    // Take our own newest task first, otherwise steal the oldest task of
+    // another deque, starting with our neighbour so thieves spread out
+    bool tryRunOne(size_t self) {
+        Task task;
+        bool found = popBack(self, task);
+        for (size_t i = 1; !found && i < queues.size(); ++i) {
+            found = stealFront((self + i) % queues.size(), task);
+        }
+        if (!found) {
+            return false;
+        }
+
+        try {
+            task.fn();
+        } catch (...) {
+            task.join->error = current_exception();
+        }
+        task.join->done.store(true, memory_order_release);
+        return true;
+    }
+
+    void workerLoop(size_t index) {
+        currentScheduler = this;
+        currentQueue = index;
+        while (!stopping.load(memory_order_acquire)) {
+            if (tryRunOne(index)) {
+                continue;
+            }
+            // Nothing to do: sleep until a push, with a timeout as a safety net
+            unique_lock<mutex> guard(sleepLock);
+            wakeUp.wait_for(guard, chrono::milliseconds(1), [this] {
+                return stopping.load(memory_order_acquire) || queuedTasks.load(memory_order_acquire) > 0;
+            });
+        }
+        currentScheduler = nullptr;
+    }
+};
+
+thread_local WorkStealingScheduler* WorkStealingScheduler::currentScheduler = nullptr;
+thread_local size_t WorkStealingScheduler::currentQueue = 0;
+
+// ============================================================================
+// PARALLEL DIVIDE-AND-CONQUER VERSIONS
+// ============================================================================
+
+/*
+ F *unction: parallelFibonacci
+ Purpose: Same recursion as fibonacci, but the two subtrees run in parallel
+ Sequential Cutoff: Below the cutoff the subtree is too small to be worth a
+ task, so we fall back to the plain recursive fibonacci. A cutoff below 1
+ is treated as 1, so the base cases are never split into fibonacci(-1)
+ */
+int parallelFibonacci(WorkStealingScheduler& scheduler, int n, int cutoff = 20) {
+    if (n <= max(cutoff, 1)) {
+        return fibonacci(n);
+    }
+
+    int left = 0;
+    int right = 0;
+    scheduler.forkJoin([&] { left = parallelFibonacci(scheduler, n - 1, cutoff); },
+                       [&] { right = parallelFibonacci(scheduler, n - 2, cutoff); });
+    return left + right;
+}
+
+/*
+ F *unction: productRange
+ Purpose: Sequential product low * (low+1) * ... * high (1 for an empty range)
+ */
+long long productRange(int low, int high) {
+    long long result = 1;
+    for (int i = low; i <= high; ++i) {
+        result *= i;
+    }
+    return result;
+}
+
+/*
+ F *unction: parallelProductRange
+ Purpose: Product tree - split [low, high] in half, multiply each half in
+ parallel, then multiply the two partial products. A single number (or an
+ empty range) is always a leaf, whatever the cutoff
+ */
+long long parallelProductRange(WorkStealingScheduler& scheduler, int low, int high, int cutoff) {
+    if (high - low < max(cutoff, 1)) {
+        return productRange(low, high);
+    }
+
+    int mid = low + (high - low) / 2;
+    long long left = 1;
+    long long right = 1;
+    scheduler.forkJoin([&] { left = parallelProductRange(scheduler, low, mid, cutoff); },
+                       [&] { right = parallelProductRange(scheduler, mid + 1, high, cutoff); });
+    return left * right;
+}
+
+/*
+ F *unction: parallelFactorial
+ Purpose: n! as a product tree over [2, n]
+ Note: Like calculateFactorial, the result only fits in long long up to 20!
+ */
+long long parallelFactorial(WorkStealingScheduler& scheduler, int n, int cutoff = 4) {
+    return parallelProductRange(scheduler, 2, n, cutoff);
+}
+
+/*
+ F *unction: factorialModulo
+ Purpose: Sequential n! mod modulus, for inputs far beyond 20!
+ Note: modulus must be below 2^32 so a product of two residues fits in 64 bits
+ */
+unsigned long long factorialModulo(int n, unsigned long long modulus) {
+    unsigned long long result = 1 % modulus;
+    for (int i = 2; i <= n; ++i) {
+        result = result * static_cast<unsigned long long>(i) % modulus;
+    }
+    return result;
+}
+
+/*
+ F *unction: parallelFactorialModulo
+ Purpose: The same product tree as parallelProductRange, but every partial
+ product is reduced mod modulus. parallelFactorial has at most 19 factors
+ before long long overflows, which is far too little work to spread across
+ cores; the modular version gives the tree millions of factors to multiply
+ */
+unsigned long long parallelProductRangeModulo(WorkStealingScheduler& scheduler, int low, int high,
+                                              unsigned long long modulus, int cutoff) {
+    if (high - low < max(cutoff, 1)) {
+        unsigned long long result = 1 % modulus;
+        for (int i = low; i <= high; ++i) {
+            result = result * static_cast<unsigned long long>(i) % modulus;
+        }
+        return result;
+    }
+
+    int mid = low + (high - low) / 2;
+    unsigned long long left = 1;
+    unsigned long long right = 1;
+    scheduler.forkJoin([&] { left = parallelProductRangeModulo(scheduler, low, mid, modulus, cutoff); },
+                       [&] { right = parallelProductRangeModulo(scheduler, mid + 1, high, modulus, cutoff); });
+    return left * right % modulus;
+}
+
+unsigned long long parallelFactorialModulo(WorkStealingScheduler& scheduler, int n,
+                                           unsigned long long modulus, int cutoff = 100000) {
+    return parallelProductRangeModulo(scheduler, 2, n, modulus, cutoff);
+}
+
+/*
+ F *unction: parallelBatchBinarySearch
+ Purpose: Look up many targets at once. The batch is split in half
+ recursively; each leaf runs recursiveBinarySearch for its share of targets
+ Result: results[i] is the index of targets[i] in arr, or -1
+ Note: A leaf holds at least one target, so a cutoff of 0 behaves like 1
+ */
+void parallelBatchSearchRange(WorkStealingScheduler& scheduler, const vector<int>& arr,
+                              const vector<int>& targets, vector<int>& results,
+                              size_t begin, size_t end, size_t cutoff) {
+    if (end - begin <= max(cutoff, size_t(1))) {
+        int right = static_cast<int>(arr.size()) - 1;
+        for (size_t i = begin; i < end; ++i) {
+            results[i] = recursiveBinarySearch(arr, targets[i], 0, right);
+        }
+        return;
+    }
+
+    size_t mid = begin + (end - begin) / 2;
+    scheduler.forkJoin([&] { parallelBatchSearchRange(scheduler, arr, targets, results, begin, mid, cutoff); },
+                       [&] { parallelBatchSearchRange(scheduler, arr, targets, results, mid, end, cutoff); });
+}
+
+vector<int> parallelBatchBinarySearch(WorkStealingScheduler& scheduler, const vector<int>& arr,
+                                      const vector<int>& targets, size_t cutoff = 2048) {
+    vector<int> results(targets.size(), -1);
+    parallelBatchSearchRange(scheduler, arr, targets, results, 0, targets.size(), cutoff);
+    return results;
+}
+
+void testParallelRecursion() {
+    cout << "\n=== PARALLEL (WORK-STEALING) TESTS ===" << endl;
+
+    WorkStealingScheduler scheduler(4);
+
+    // Test case 1: Fibonacci with a small cutoff so many tasks get forked
+    cout << "\nTest 1 - parallelFibonacci matches fibonacci for 0..27:" << endl;
+    bool fibonacciMatches = true;
+    for (int i = 0; i <= 27; i++) {
+        if (parallelFibonacci(scheduler, i, 5) != fibonacci(i)) {
+            fibonacciMatches = false;
+        }
+    }
+    cout << "Result: " << (fibonacciMatches ? "PASS" : "FAIL") << endl;
+
+    // Test case 2: Factorial product tree against the recursive version
+    cout << "\nTest 2 - parallelFactorial matches calculateFactorial for 0..20:" << endl;
+    bool factorialMatches = true;
+    for (int n = 0; n <= 20; n++) {
+        if (parallelFactorial(scheduler, n, 1) != calculateFactorial(n)) {
+            factorialMatches = false;
+        }
+    }
+    cout << "Result: " << (factorialMatches ? "PASS" : "FAIL") << endl;
+
+    // Test case 3: A cutoff of 3 gives leaves of different sizes, so the
+    // split points differ from Test 2
+    cout << "\nTest 3 - parallelFactorial with cutoff 3 matches calculateFactorial for 0..20:" << endl;
+    bool productMatches = true;
+    for (int n = 0; n <= 20; n++) {
+        if (parallelFactorial(scheduler, n, 3) != calculateFactorial(n)) {
+            productMatches = false;
+        }
+    }
+    cout << "Result: " << (productMatches ? "PASS" : "FAIL") << endl;
+
+    // Test case 4: Modular product tree against the sequential loop and 20!
+    cout << "\nTest 4 - parallelFactorialModulo matches factorialModulo:" << endl;
+    const unsigned long long modulus = 1000000007ULL;
+    bool moduloMatches = parallelFactorialModulo(scheduler, 20, modulus, 1)
+                         == static_cast<unsigned long long>(calculateFactorial(20)) % modulus;
+    for (int n : {0, 1, 2, 1000, 123457}) {
+        if (parallelFactorialModulo(scheduler, n, modulus, 64) != factorialModulo(n, modulus)) {
+            moduloMatches = false;
+        }
+    }
+    cout << "Result: " << (moduloMatches ? "PASS" : "FAIL") << endl;
+
+    // Test case 5: Batched search, half the targets present and half missing
+    cout << "\nTest 5 - parallelBatchBinarySearch matches recursiveBinarySearch:" << endl;
+    vector<int> sortedArray;
+    for (int i = 0; i < 5000; i++) {
+        sortedArray.push_back(i * 2);
+    }
+    vector<int> targets;
+    for (int i = -10; i < 10010; i++) {
+        targets.push_back(i);
+    }
+    vector<int> results = parallelBatchBinarySearch(scheduler, sortedArray, targets, 64);
+    bool searchMatches = true;
+    for (size_t i = 0; i < targets.size(); i++) {
+        int expected = recursiveBinarySearch(sortedArray, targets[i], 0, static_cast<int>(sortedArray.size()) - 1);
+        if (results[i] != expected) {
+            searchMatches = false;
+        }
+    }
+    cout << "Result: " << (searchMatches ? "PASS" : "FAIL") << endl;
+
+    // Test case 6: Edge case - empty batch and empty array
+    cout << "\nTest 6 - Empty batch and empty array (Edge Case):" << endl;
+    vector<int> emptyResults = parallelBatchBinarySearch(scheduler, sortedArray, {});
+    vector<int> missing = parallelBatchBinarySearch(scheduler, {}, {1, 2, 3});
+    bool emptyOk = emptyResults.empty() && missing == vector<int>{-1, -1, -1};
+    cout << "Result: " << (emptyOk ? "PASS" : "FAIL") << endl;
+
+    // Test case 7: A cutoff of 0 must still stop splitting at single elements
+    cout << "\nTest 7 - Cutoff of 0 (Edge Case):" << endl;
+    bool zeroCutoffOk = parallelFibonacci(scheduler, 15, 0) == fibonacci(15)
+                        && parallelFactorial(scheduler, 12, 0) == calculateFactorial(12)
+                        && parallelBatchBinarySearch(scheduler, sortedArray, {0, 1, 9998}, 0)
+                               == vector<int>{0, -1, 4999};
+    cout << "Result: " << (zeroCutoffOk ? "PASS" : "FAIL") << endl;
+}
+
+void testMemoization() {
+    cout << "\n=== MEMOIZATION TESTS ===" << endl;
+
+    // Test case 1: Memoized fibonacci against the plain recursion
+    cout << "\nTest 1 - memoizedFibonacci matches fibonacci for 0..30:" << endl;
+    bool fibonacciMatches = true;
+    for (int i = 0; i <= 30; i++) {
+        if (memoizedFibonacci(i) != fibonacci(i)) {
+            fibonacciMatches = false;
+        }
+    }
+    cout << "Result: " << (fibonacciMatches ? "PASS" : "FAIL") << endl;
+
+    // Test case 2: Memoized factorial against the sequential product
+    cout << "\nTest 2 - memoizedFactorial matches sequential product for 0..20:" << endl;
+    bool factorialMatches = true;
+    for (int n = 0; n <= 20; n++) {
+        if (memoizedFactorial(n) != productRange(2, n)) {
+            factorialMatches = false;
+        }
+    }
+    cout << "Result: " << (factorialMatches ? "PASS" : "FAIL") << endl;
+
+    // Test case 3: A tiny cache with eviction stays within its bound and is still correct
+    cout << "\nTest 3 - Capacity 8 with eviction:" << endl;
+    MemoCacheOptions small;
+    small.capacity = 8;
+    small.shards = 2;
+    auto smallFibonacci = memoize<int(int)>([](const auto& self, int n) {
+        return n < 2 ? n : self(n - 1) + self(n - 2);
+    }, small);
+    bool smallOk = smallFibonacci(25) == fibonacci(25) && smallFibonacci.cacheStore().size() <= 8;
+    cout << "Entries: " << smallFibonacci.cacheStore().size()
+         << ", evictions: " << smallFibonacci.cacheStore().evictions() << endl;
+    cout << "Result: " << (smallOk ? "PASS" : "FAIL") << endl;
+
+    // Test case 4: Without eviction the cache stops growing once full
+    cout << "\nTest 4 - Capacity 8 without eviction (Edge Case):" << endl;
+    small.evict = false;
+    auto fixedFibonacci = memoize<int(int)>([](const auto& self, int n) {
+        return n < 2 ? n : self(n - 1) + self(n - 2);
+    }, small);
+    bool fixedOk = fixedFibonacci(20) == fibonacci(20) && fixedFibonacci.cacheStore().size() <= 8
+                   && fixedFibonacci.cacheStore().evictions() == 0;
+    cout << "Result: " << (fixedOk ? "PASS" : "FAIL") << endl;
+
+    // Test case 5: Capacity that is not a multiple of the shard count
+    cout << "\nTest 5 - Capacity 10 over 16 shards and 7 over 3 shards (Edge Case):" << endl;
+    bool unevenOk = true;
+    for (auto [capacity, shardCount] : {pair<size_t, size_t>{10, 16}, pair<size_t, size_t>{7, 3}}) {
+        MemoCacheOptions uneven;
+        uneven.capacity = capacity;
+        uneven.shards = shardCount;
+        auto unevenFibonacci = memoize<int(int)>([](const auto& self, int n) {
+            return n < 2 ? n : self(n - 1) + self(n - 2);
+        }, uneven);
+        for (int i = 0; i <= 30; i++) {
+            if (unevenFibonacci(i) != memoizedFibonacci(i)) {
+                unevenOk = false;
+            }
+        }
+        if (unevenFibonacci.cacheStore().size() != capacity) {
+            unevenOk = false;
+        }
+    }
+    cout << "Result: " << (unevenOk ? "PASS" : "FAIL") << endl;
+
+    // Test case 6: Several threads sharing one cache all get the right answers
+    cout << "\nTest 6 - 4 threads sharing one memoized fibonacci:" << endl;
+    auto sharedFibonacci = memoize<long long(int)>([](const auto& self, int n) -> long long {
+        return n < 2 ? n : self(n - 1) + self(n - 2);
+    });
+    vector<long long> expected = {0, 1};
+    for (int i = 2; i <= 40; i++) {
+        expected.push_back(expected[i - 1] + expected[i - 2]);
+    }
+    atomic<bool> sharedOk{true};
+    vector<thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([&, t] {
+            for (int i = 40; i >= 0; i--) {
+                int n = (i + t * 7) % 41;
+                if (sharedFibonacci(n) != expected[n]) {
+                    sharedOk = false;
+                }
+            }
+        });
+    }
+    for (auto& th : threads) {
+        th.join();
+    }
+    cout << "Result: " << (sharedOk ? "PASS" : "FAIL") << endl;
+}
+
+// ============================================================================
+// STACK-SAFE RECURSION USING AN EXPLICIT STACK
+// ============================================================================
+
+/*
+ C *lass: ExplicitStack
+ Purpose: A call stack that lives on the heap instead of the native thread stack
+ Explanation:
+ - Each frame is a small fixed-size struct holding only what one recursive
+   call needs - no return address, saved registers or function prologue
+ - The first few frames live in a small inline array (no heap allocation
+   for shallow recursions); deeper frames spill into one growable heap array,
+   so the maximum depth is limited by available memory rather than the
+   (usually 8 MB) thread stack
+ - "Calling" is push(), "returning" is pop()
+ */
+template <typename Frame, size_t InlineFrames = 16>
+class ExplicitStack {
+    static_assert(is_trivially_copyable<Frame>::value, "frames must be plain fixed-size structs");
+
+public:
+    explicit ExplicitStack(size_t expectedDepth = 0) {
+        if (expectedDepth > InlineFrames) {
+            spilled.reserve(expectedDepth - InlineFrames);
+        }
+    }
+
+    void push(const Frame& frame) {
+        if (depth < InlineFrames) {
+            inlineFrames[depth] = frame;
+        } else {
+            spilled.push_back(frame);
+        }
+        depth++;
+    }
+
+    Frame pop() {
+        depth--;
+        if (depth < InlineFrames) {
+            return inlineFrames[depth];
+        }
+        Frame top = spilled.back();
+        spilled.pop_back();
+        return top;
+    }
+
+    bool empty() const { return depth == 0; }
+
+private:
+    Frame inlineFrames[InlineFrames];
+    vector<Frame> spilled;
+    size_t depth = 0;
+};
+
+/*
+ F *unction: stackSafeFactorial
+ Purpose: calculateFactorial run on an ExplicitStack
+ How it works:
+ - Going down: push a frame for n, n-1, ..., 2 (the calls that are waiting
+   for factorial(n-1) to return)
+ - Base case: factorial(1) = factorial(0) = 1
+ - Coming back up: pop each frame and multiply it into the result
+ - stackSafeFactorialModulo reduces each product mod modulus (which must
+   be below 2^32); a modulus of 0 means plain wrap-around mod 2^64
+ Note: Only 20! fits in long long. Beyond that stackSafeFactorial returns the
+ low 64 bits of n!, computed in unsigned arithmetic so deep inputs never
+ overflow a signed value
+ */
+unsigned long long stackSafeFactorialModulo(int n, unsigned long long modulus) {
+    struct Frame {
+        int n;
+    };
+
+    ExplicitStack<Frame> stack(n > 1 ? n : 0);
+    while (n > 1) {
+        stack.push(Frame{n});
+        n--;
+    }
+
+    unsigned long long result = modulus == 0 ? 1 : 1 % modulus;
+    while (!stack.empty()) {
+        result *= static_cast<unsigned long long>(stack.pop().n);
+        if (modulus != 0) {
+            result %= modulus;
+        }
+    }
+    return result;
+}
+
+long long stackSafeFactorial(int n) {
+    return static_cast<long long>(stackSafeFactorialModulo(n, 0));
+}
+
+/*
+ F *unction: stackSafeReverseString
+ Purpose: reverseString run on an ExplicitStack
+ How it works:
+ - A frame only stores where its substring starts, instead of a copy of the
+   substring, so every frame has the same small size
+ - Going down: push frames until the remaining substring has 0 or 1 characters
+ - Coming back up: each frame appends its first character to the result,
+   exactly like "reverseString(str.substr(1)) + str[0]"
+ - The result is built in one buffer, so the work is O(n) instead of the
+   O(n^2) copying done by substr() in the native version
+ */
+string stackSafeReverseString(const string& str) {
+    struct Frame {
+        size_t start;
+    };
+
+    ExplicitStack<Frame> stack(str.length());
+    size_t start = 0;
+    while (str.length() - start > 1) {
+        stack.push(Frame{start});
+        start++;
+    }
+
+    string reversed;
+    reversed.reserve(str.length());
+    reversed += str.substr(start);  // base case: empty or one character
+    while (!stack.empty()) {
+        reversed += str[stack.pop().start];
+    }
+    return reversed;
+}
+
+/*
+ F *unction: stackSafeBinarySearch
+ Purpose: recursiveBinarySearch run on an ExplicitStack
+ Explanation: Both recursive cases are tail calls (nothing happens after the
+ child returns), so each frame is popped before its child is pushed and the
+ stack never holds more than one frame
+ */
+int stackSafeBinarySearch(const vector<int>& arr, int target, int left, int right) {
+    struct Frame {
+        int left;
+        int right;
+    };
+
+    ExplicitStack<Frame> stack;
+    stack.push(Frame{left, right});
+    while (!stack.empty()) {
+        Frame frame = stack.pop();
+        if (frame.left > frame.right) {
+            return -1;
+        }
+
+        int mid = frame.left + (frame.right - frame.left) / 2;
+        if (arr[mid] == target) {
+            return mid;
+        }
+
+        if (target < arr[mid]) {
+            stack.push(Frame{frame.left, mid - 1});
+        } else {
+            stack.push(Frame{mid + 1, frame.right});
+        }
+    }
+    return -1;
+}
+
+void testStackSafeRecursion() {
+    cout << "\n=== STACK-SAFE (EXPLICIT STACK) TESTS ===" << endl;
+
+    // Test case 1: Factorial against the recursive version
+    cout << "\nTest 1 - stackSafeFactorial matches calculateFactorial for 0..20:" << endl;
+    bool factorialMatches = true;
+    for (int n = 0; n <= 20; n++) {
+        if (stackSafeFactorial(n) != calculateFactorial(n)) {
+            factorialMatches = false;
+        }
+    }
+    cout << "Result: " << (factorialMatches ? "PASS" : "FAIL") << endl;
+
+    // Test case 2: Past 20! against n! mod 2^64 from a plain unsigned loop.
+    // 21..65 give non-zero wrapped values; from 66 on 2^64 divides n!, so the
+    // deep inputs are 0 for any correct implementation. These depths only
+    // overflow the native stack in unoptimised (-O0) builds: at -O2 GCC turns
+    // calculateFactorial into a loop
+    cout << "\nTest 2 - stackSafeFactorial matches n! mod 2^64 for 21..65, 2000000 and 5000000 (Depth That Overflows Unoptimised Builds):" << endl;
+    bool deepMatches = true;
+    vector<int> deepInputs = {2000000, 5000000};
+    for (int n = 21; n <= 65; n++) {
+        deepInputs.push_back(n);
+    }
+    for (int n : deepInputs) {
+        unsigned long long expected = 1;
+        for (int i = 2; i <= n; i++) {
+            expected *= static_cast<unsigned long long>(i);
+        }
+        if (stackSafeFactorial(n) != static_cast<long long>(expected) || (n <= 65 && expected == 0)) {
+            deepMatches = false;
+        }
+    }
+    cout << "Result: " << (deepMatches ? "PASS" : "FAIL") << endl;
+
+    // Test case 3: A deep input with a non-zero result - 2000000! mod a prime
+    cout << "\nTest 3 - stackSafeFactorialModulo(2000000, 1000000007) matches factorialModulo (Depth That Overflows Unoptimised Builds):" << endl;
+    unsigned long long deepModulo = stackSafeFactorialModulo(2000000, 1000000007ULL);
+    bool deepModuloOk = deepModulo != 0 && deepModulo == factorialModulo(2000000, 1000000007ULL);
+    cout << "Result: " << (deepModuloOk ? "PASS" : "FAIL") << endl;
+
+    // Test case 4: Same answers as reverseString on the usual inputs
+    cout << "\nTest 4 - stackSafeReverseString matches reverseString:" << endl;
+    bool reverseMatches = true;
+    for (const string& text : {string(""), string("A"), string("hello"), string("recursion"), string(2000, 'x') + "yz"}) {
+        if (stackSafeReverseString(text) != reverseString(text)) {
+            reverseMatches = false;
+        }
+    }
+    cout << "Result: " << (reverseMatches ? "PASS" : "FAIL") << endl;
+
+    // Test case 5: A 5 million character string - one frame per character.
+    // The native reverseString crashes at this depth even at -O2
+    cout << "\nTest 5 - stackSafeReverseString on 5,000,000 characters (Depth That Crashes Native Recursion):" << endl;
+    string longText;
+    for (int i = 0; i < 5000000; i++) {
+        longText += static_cast<char>('a' + i % 26);
+    }
+    string expected(longText.rbegin(), longText.rend());
+    cout << "Result: " << (stackSafeReverseString(longText) == expected ? "PASS" : "FAIL") << endl;
+
+    // Test case 6: Binary search against the recursive version, found and missing
+    cout << "\nTest 6 - stackSafeBinarySearch matches recursiveBinarySearch:" << endl;
+    vector<int> sortedArray = {2, 5, 8, 12, 16, 23, 38, 45, 67, 89};
+    vector<int> emptyArray = {};
+    bool searchMatches = stackSafeBinarySearch(emptyArray, 5, 0, -1) == -1;
+    for (int target = 0; target <= 100; target++) {
+        if (stackSafeBinarySearch(sortedArray, target, 0, 9) != recursiveBinarySearch(sortedArray, target, 0, 9)) {
+            searchMatches = false;
+        }
+    }
+    cout << "Result: " << (searchMatches ? "PASS" : "FAIL") << endl;
+}
+
+// ============================================================================
+// BENCHMARKS
+// ============================================================================
+
+// Run fn once and return how long it took in milliseconds
+template <typename F>
+double timeMilliseconds(F&& fn) {
+    auto start = chrono::steady_clock::now();
+    fn();
+    auto stop = chrono::steady_clock::now();
+    return chrono::duration<double, milli>(stop - start).count();
+}
+
+void benchmarkParallelScaling() {
+    cout << "\n=== BENCHMARK: WORK-STEALING SCALING ===" << endl;
+
+    // forkJoin callers help run tasks, so a scheduler with w workers keeps
+    // w + 1 threads busy (the workers plus the calling thread). Rows are
+    // labelled with that total; the sequential run is the 1-thread baseline
+    unsigned maxThreads = max(thread::hardware_concurrency(), 2u);
+    vector<unsigned> threadCounts;
+    for (unsigned threads = 2; threads < maxThreads; threads *= 2) {
+        threadCounts.push_back(threads);
+    }
+    threadCounts.push_back(maxThreads);
+
+    // Results go into a volatile so the optimiser cannot drop the work
+    volatile long long sink = 0;
+
+    const int fibonacciInput = 34;
+    double sequentialFibonacci = timeMilliseconds([&] { sink = fibonacci(fibonacciInput); });
+    cout << "\nfibonacci(" << fibonacciInput << ") sequential: " << sequentialFibonacci << " ms" << endl;
+
+    vector<int> sortedArray;
+    for (int i = 0; i < 1000000; i++) {
+        sortedArray.push_back(i * 2);
+    }
+    vector<int> targets;
+    for (int i = 0; i < 4000000; i++) {
+        targets.push_back(static_cast<int>((i * 7919LL) % 2000000));
+    }
+    double sequentialSearch = timeMilliseconds([&] {
+        int right = static_cast<int>(sortedArray.size()) - 1;
+        for (int target : targets) {
+            sink = recursiveBinarySearch(sortedArray, target, 0, right);
+        }
+    });
+    cout << "batched binary search (" << targets.size() << " targets) sequential: "
+         << sequentialSearch << " ms" << endl;
+
+    const int factorialInput = 50000000;
+    const unsigned long long modulus = 1000000007ULL;
+    double sequentialFactorial = timeMilliseconds([&] { sink = factorialModulo(factorialInput, modulus); });
+    cout << "factorial(" << factorialInput << ") mod " << modulus << " sequential: "
+         << sequentialFactorial << " ms" << endl;
+
+    cout << "\nThreads | fibonacci ms | speedup | batch search ms | speedup | factorial mod p ms | speedup" << endl;
+    for (unsigned threads : threadCounts) {
+        WorkStealingScheduler scheduler(threads - 1);
+        double fibonacciTime = timeMilliseconds([&] { sink = parallelFibonacci(scheduler, fibonacciInput); });
+        double searchTime = timeMilliseconds([&] { sink = parallelBatchBinarySearch(scheduler, sortedArray, targets).back(); });
+        double factorialTime = timeMilliseconds([&] { sink = parallelFactorialModulo(scheduler, factorialInput, modulus); });
+        cout << threads << " | " << fibonacciTime << " | " << sequentialFibonacci / fibonacciTime
+             << "x | " << searchTime << " | " << sequentialSearch / searchTime
+             << "x | " << factorialTime << " | " << sequentialFactorial / factorialTime << "x" << endl;
+    }
+}
+
+void benchmarkMemoization() {
+    cout << "\n=== BENCHMARK: MEMOIZATION ===" << endl;
+
+    volatile long long sink = 0;
+    const int maxInput = 25;
+    auto fibonacciBody = [](const auto& self, int n) -> long long {
+        return n < 2 ? n : self(n - 1) + self(n - 2);
+    };
+    // Same access pattern as printFibonacciSequence: fib(i) for every i, repeated
+    auto workload = [&](const Memoized<long long(int)>& fib, int rounds) {
+        for (int r = 0; r < rounds; r++) {
+            for (int i = 0; i <= maxInput; i++) {
+                sink = fib(i);
+            }
+        }
+    };
+    auto callsPerSecond = [&](int rounds, double ms) {
+        return rounds * (maxInput + 1) / (ms / 1000.0);
+    };
+
+    // Cache off: every top-level call redoes the whole recursion tree
+    MemoCacheOptions off;
+    off.enabled = false;
+    auto uncached = memoize<long long(int)>(fibonacciBody, off);
+    const int coldRounds = 5;
+    double offTime = timeMilliseconds([&] { workload(uncached, coldRounds); });
+    cout << "\nCache off:  " << callsPerSecond(coldRounds, offTime) << " calls/s, 0 bytes cached" << endl;
+
+    // Warm cache: after the first round every call is a single lookup
+    auto cached = memoize<long long(int)>(fibonacciBody);
+    workload(cached, 1);
+    const int warmRounds = 20000;
+    double warmTime = timeMilliseconds([&] { workload(cached, warmRounds); });
+    cout << "Warm cache: " << callsPerSecond(warmRounds, warmTime) << " calls/s, "
+         << cached.cacheStore().size() << " entries, ~"
+         << cached.cacheStore().approximateBytes() << " bytes" << endl;
+
+    // Contention: several threads hammer the same warm cache, once with a
+    // single lock and once with the default lock striping
+    unsigned threadCount = max(4u, thread::hardware_concurrency());
+    for (size_t shardCount : {size_t(1), MemoCacheOptions().shards}) {
+        MemoCacheOptions options;
+        options.shards = shardCount;
+        auto shared = memoize<long long(int)>(fibonacciBody, options);
+        workload(shared, 1);
+        double sharedTime = timeMilliseconds([&] {
+            vector<thread> threads;
+            for (unsigned t = 0; t < threadCount; t++) {
+                threads.emplace_back([&] { workload(shared, warmRounds); });
+            }
+            for (auto& th : threads) {
+                th.join();
+            }
+        });
+        cout << threadCount << " threads, " << shardCount << " shard(s): "
+             << callsPerSecond(warmRounds * threadCount, sharedTime) << " calls/s, "
+             << shared.cacheStore().size() << " entries, ~"
+             << shared.cacheStore().approximateBytes() << " bytes" << endl;
+    }
+}
+
+void benchmarkStackSafeRecursion() {
+    cout << "\n=== BENCHMARK: NATIVE VS EXPLICIT STACK ===" << endl;
+
+    volatile long long sink = 0;
+
+    // String reversal at a depth the native version can still handle
+    string text(20000, 'r');
+    const int reverseRounds = 5;
+    double nativeReverse = timeMilliseconds([&] {
+        for (int r = 0; r < reverseRounds; r++) {
+            sink = reverseString(text).size();
+        }
+    });
+    double explicitReverse = timeMilliseconds([&] {
+        for (int r = 0; r < reverseRounds; r++) {
+            sink = stackSafeReverseString(text).size();
+        }
+    });
+    cout << "\nreverseString (" << text.size() << " chars) native: " << nativeReverse / reverseRounds
+         << " ms, explicit stack: " << explicitReverse / reverseRounds << " ms" << endl;
+
+    // Many small binary searches, where per-call overhead dominates
+    vector<int> sortedArray;
+    for (int i = 0; i < 1000000; i++) {
+        sortedArray.push_back(i * 2);
+    }
+    int right = static_cast<int>(sortedArray.size()) - 1;
+    const int searches = 2000000;
+    double nativeSearch = timeMilliseconds([&] {
+        for (int i = 0; i < searches; i++) {
+            sink = recursiveBinarySearch(sortedArray, i, 0, right);
+        }
+    });
+    double explicitSearch = timeMilliseconds([&] {
+        for (int i = 0; i < searches; i++) {
+            sink = stackSafeBinarySearch(sortedArray, i, 0, right);
+        }
+    });
+    cout << "binary search (" << searches << " lookups) native: " << nativeSearch
+         << " ms, explicit stack: " << explicitSearch << " ms" << endl;
+
+    // Factorial: short recursions, so this is mostly per-call overhead
+    const int factorialRounds = 1000000;
+    double nativeFactorial = timeMilliseconds([&] {
+        for (int i = 0; i < factorialRounds; i++) {
+            sink = calculateFactorial(20 - i % 8);
+        }
+    });
+    double explicitFactorial = timeMilliseconds([&] {
+        for (int i = 0; i < factorialRounds; i++) {
+            sink = stackSafeFactorial(20 - i % 8);
+        }
+    });
+    cout << "factorial (" << factorialRounds << " calls) native: " << nativeFactorial
+         << " ms, explicit stack: " << explicitFactorial << " ms" << endl;
+
+    // Depths only the explicit stack can reach
+    string deepText(5000000, 'd');
+    double deepReverse = timeMilliseconds([&] { sink = stackSafeReverseString(deepText).size(); });
+    double deepFactorial = timeMilliseconds([&] { sink = stackSafeFactorial(5000000); });
+    cout << "explicit stack only: reverse 5,000,000 chars " << deepReverse
+         << " ms, factorial(5000000) " << deepFactorial << " ms" << endl;
+}
+
 // ============================================================================
 // MAIN FUNCTION - TEST ALL RECURSIVE FUNCTIONS
 // ============================================================================
 
-int main() {
+int main(int argc, char* argv[]) {
+    bool runBenchmarks = false;
+    bool profileAsJson = false;
+    string profileJsonPath;  // empty = stderr
+    for (int i = 1; i < argc; i++) {
+        string option = argv[i];
+        if (option == "--bench") {
+            runBenchmarks = true;
+        } else if (option == "--profile-json") {
+            profileAsJson = true;
+        } else if (option.rfind("--profile-json=", 0) == 0) {
+            profileAsJson = true;
+            profileJsonPath = option.substr(string("--profile-json=").length());
+        }
+    }
+
+#ifndef RECURSION_PROFILING
+    if (profileAsJson) {
+        cerr << "--profile-json ignored: this binary was built without RECURSION_PROFILING "
+             << "(rebuild with -DRECURSION_PROFILING)" << endl;
+    }
+#endif
+
     cout << "CSC 301 - Data Structures - Recursion Assignment" << endl;
     cout << "================================================" << endl;
 
@@ -252,8 +1727,33 @@ int main() {
     testFibonacci();
     testStringReversal();
     testBinarySearch();
+    testParallelRecursion();
+    testMemoization();
+    testStackSafeRecursion();
 
     cout << "\n=== ALL TESTS COMPLETED ===" << endl;
 
+    if (runBenchmarks) {
+        benchmarkParallelScaling();
+        benchmarkMemoization();
+        benchmarkStackSafeRecursion();
+    }
+
+#ifdef RECURSION_PROFILING
+    // JSON goes to its own stream so it is not mixed with the test output
+    if (!profileAsJson) {
+        printRecursionProfile(cout);
+    } else if (profileJsonPath.empty()) {
+        printRecursionProfileJson(cerr);
+    } else {
+        ofstream jsonFile(profileJsonPath);
+        if (!jsonFile) {
+            cerr << "ERROR: Cannot write profile to " << profileJsonPath << endl;
+            return 1;
+        }
+        printRecursionProfileJson(jsonFile);
+    }
+#endif
+
     return 0;
 }